@@ -0,0 +1,68 @@
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "viaduct.h"
+
+#define DEFAULT_ITERATIONS 1000000
+
+// discard everything; the benchmark only measures building and serializing messages
+size_t null_write(struct wamp_client* this, const uint8_t* buf, size_t len) {
+	return len;
+}
+
+#ifdef VIADUCT_NO_MSGPACK
+// stand-in for an application supplied serializer when msgpack is compiled out
+// it does no serializing, so its throughput says nothing about publishing
+void serialize_count(struct wamp_client* cl, wamp_type_list msg) {
+	cl->buf_len = msg.len;
+	cl->write(cl, cl->buf, cl->buf_len);
+}
+#endif
+
+double now_sec() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int main(int argc, char* argv[]) {
+	long iterations = DEFAULT_ITERATIONS;
+	if (argc > 1) {
+		iterations = atol(argv[1]);
+	}
+
+	struct wamp_client a;
+	memset(&a, 0, sizeof(a));
+	a.write = null_write;
+#ifdef VIADUCT_NO_MSGPACK
+	a.serialize = serialize_count;
+#else
+	a.serialize = serialize_msgpack;
+#endif
+
+	struct wamp_type arg_list[] = {
+		{
+			.type = TYPE_STRING,
+			.string = {.len = 12, .val = "some message"},
+		},
+		{
+			.type = TYPE_INT,
+			.integer = 42,
+		},
+	};
+	wamp_type_list args = {.len = 2, .val = arg_list};
+	wamp_type_string topic = {.len = 8, .val = "messages"};
+
+	double start = now_sec();
+	long i;
+	for (i = 0; i < iterations; i++) {
+		viaduct_publish(&a, NULL, topic, &args, NULL);
+	}
+	double elapsed = now_sec() - start;
+
+	printf("%.0f\n", iterations / elapsed);
+	return 0;
+}
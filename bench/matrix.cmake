@@ -0,0 +1,173 @@
+# Builds viaduct in each configuration below and prints a table of library
+# size, size of the linked benchmark and publish throughput.
+#
+# Run through the `matrix` target, or directly:
+#
+#	cmake -DSOURCE_DIR=. -DBINARY_DIR=matrix -P bench/matrix.cmake
+#
+# Library sizes of LTO builds are left out because their objects hold
+# compiler IR instead of machine code; compare the bench columns instead.
+# The compiler, toolchain file and flags of the calling build are reused, so
+# cross builds report sizes for the target. Pass -DSIZE_COMMAND=... to the
+# calling build if the matching size isn't found. When cross compiling the
+# bench isn't run, and a bench that fails to link is skipped.
+#
+# Throughput is only reported with msgpack, since without it the bench
+# serializer does no work and the numbers aren't comparable.
+
+if(NOT BUILD_TYPE)
+	set(BUILD_TYPE Release)
+endif()
+if(NOT SIZE_COMMAND)
+	set(SIZE_COMMAND size)
+endif()
+
+set(configs
+	"shared|"
+	"static|-DBUILD_SHARED_LIBS=OFF"
+	"static-lto|-DBUILD_SHARED_LIBS=OFF,-DCMAKE_INTERPROCEDURAL_OPTIMIZATION=ON"
+	"static-no-msgpack|-DBUILD_SHARED_LIBS=OFF,-DVIADUCT_SERIALIZER_MSGPACK=OFF"
+	"static-lto-no-msgpack|-DBUILD_SHARED_LIBS=OFF,-DCMAKE_INTERPROCEDURAL_OPTIMIZATION=ON,-DVIADUCT_SERIALIZER_MSGPACK=OFF"
+	"static-core|-DBUILD_SHARED_LIBS=OFF,-DVIADUCT_ROLE_PUBLISHER=OFF,-DVIADUCT_SERIALIZER_MSGPACK=OFF"
+)
+
+# sets text and data in the caller to the totals reported by size for files
+function(measure files)
+	set(text "-" PARENT_SCOPE)
+	set(data "-" PARENT_SCOPE)
+	if(NOT files)
+		return()
+	endif()
+	execute_process(COMMAND ${SIZE_COMMAND} -t ${files}
+		OUTPUT_VARIABLE out
+		RESULT_VARIABLE res
+		ERROR_QUIET)
+	if(NOT res EQUAL 0)
+		return()
+	endif()
+	string(REGEX MATCH "[^\n]*\\(TOTALS\\)" total "${out}")
+	string(STRIP "${total}" total)
+	string(REGEX REPLACE "[ \t]+" ";" total "${total}")
+	list(LENGTH total len)
+	if(len EQUAL 6)
+		list(GET total 0 total_text)
+		list(GET total 1 total_data)
+		set(text ${total_text} PARENT_SCOPE)
+		set(data ${total_data} PARENT_SCOPE)
+	endif()
+endfunction()
+
+function(pad str width)
+	string(LENGTH "${str}" len)
+	while(len LESS width)
+		set(str "${str} ")
+		math(EXPR len "${len} + 1")
+	endwhile()
+	set(padded "${str}" PARENT_SCOPE)
+endfunction()
+
+set(widths 24 10 10 12 12 12)
+
+set(rows)
+foreach(config ${configs})
+	string(REGEX REPLACE "\\|.*" "" name "${config}")
+	string(REPLACE "," ";" options "${config}")
+	string(REGEX REPLACE "^[^|]*\\|" "" options "${options}")
+
+	# start clean so options and libraries from a previous run don't linger
+	set(dir "${BINARY_DIR}/${name}")
+	file(REMOVE_RECURSE "${dir}")
+	file(MAKE_DIRECTORY "${dir}")
+	message(STATUS "Building ${name}")
+
+	set(args -DCMAKE_BUILD_TYPE=${BUILD_TYPE})
+	if(TOOLCHAIN_FILE)
+		list(APPEND args "-DCMAKE_TOOLCHAIN_FILE=${TOOLCHAIN_FILE}")
+	endif()
+	if(C_COMPILER)
+		list(APPEND args "-DCMAKE_C_COMPILER=${C_COMPILER}")
+	endif()
+	if(C_FLAGS)
+		list(APPEND args "-DCMAKE_C_FLAGS=${C_FLAGS}")
+	endif()
+	if(EXE_LINKER_FLAGS)
+		list(APPEND args "-DCMAKE_EXE_LINKER_FLAGS=${EXE_LINKER_FLAGS}")
+	endif()
+	execute_process(COMMAND ${CMAKE_COMMAND} ${args} ${options} "${SOURCE_DIR}"
+		WORKING_DIRECTORY "${dir}"
+		OUTPUT_QUIET
+		RESULT_VARIABLE res)
+	if(NOT res EQUAL 0)
+		message(FATAL_ERROR "Configuring ${name} failed")
+	endif()
+
+	# the tests need libtap, so only build what is measured
+	execute_process(COMMAND ${CMAKE_COMMAND} --build . --target viaduct
+		WORKING_DIRECTORY "${dir}"
+		OUTPUT_QUIET
+		RESULT_VARIABLE res)
+	if(NOT res EQUAL 0)
+		message(FATAL_ERROR "Building ${name} failed")
+	endif()
+
+	set(has_bench FALSE)
+	if(NOT config MATCHES "ROLE_PUBLISHER=OFF")
+		set(has_bench TRUE)
+		execute_process(COMMAND ${CMAKE_COMMAND} --build . --target bench
+			WORKING_DIRECTORY "${dir}"
+			OUTPUT_QUIET
+			RESULT_VARIABLE res)
+		if(NOT res EQUAL 0)
+			if(NOT CROSSCOMPILING)
+				message(FATAL_ERROR "Building bench for ${name} failed")
+			endif()
+			message(WARNING "Building bench for ${name} failed, skipping it")
+			set(has_bench FALSE)
+		endif()
+	endif()
+
+	# cmp is linked into the shared library but kept separate when static
+	if(config MATCHES "INTERPROCEDURAL_OPTIMIZATION=ON")
+		set(libs)
+	elseif(config MATCHES "BUILD_SHARED_LIBS=OFF")
+		file(GLOB libs "${dir}/libviaduct.a" "${dir}/libcmp.a")
+	else()
+		file(GLOB libs "${dir}/libviaduct.so")
+	endif()
+	measure("${libs}")
+	set(lib_text ${text})
+	set(lib_data ${data})
+
+	set(bench_text "-")
+	set(bench_data "-")
+	set(throughput "-")
+	if(has_bench)
+		measure("${dir}/bench")
+		set(bench_text ${text})
+		set(bench_data ${data})
+		if(NOT CROSSCOMPILING AND NOT config MATCHES "SERIALIZER_MSGPACK=OFF")
+			execute_process(COMMAND "${dir}/bench"
+				OUTPUT_VARIABLE throughput
+				OUTPUT_STRIP_TRAILING_WHITESPACE)
+		endif()
+	endif()
+
+	set(row "${name}|${lib_text}|${lib_data}|${bench_text}|${bench_data}|${throughput}")
+	list(APPEND rows "${row}")
+endforeach()
+
+set(lines)
+foreach(row "configuration|lib text|lib data|bench text|bench data|publish/s" ${rows})
+	string(REPLACE "|" ";" cells "${row}")
+	set(line "")
+	set(i 0)
+	foreach(cell ${cells})
+		list(GET widths ${i} width)
+		pad("${cell}" ${width})
+		set(line "${line}${padded}")
+		math(EXPR i "${i} + 1")
+	endforeach()
+	set(lines "${lines}${line}\n")
+endforeach()
+
+message("\n${BUILD_TYPE} build, sizes in bytes\n\n${lines}")
@@ -8,7 +8,17 @@
 
 #define BYTES_TO_LEN_TESTS 3
 #define LEN_TO_BYTES_TESTS 3
-#define TESTS (BYTES_TO_LEN_TESTS + LEN_TO_BYTES_TESTS)
+#ifndef VIADUCT_NO_PUBLISHER
+#define PUBLISH_TESTS 2
+#else
+#define PUBLISH_TESTS 0
+#endif
+#if !defined(VIADUCT_NO_PUBLISHER) && !defined(VIADUCT_NO_MSGPACK)
+#define PUBLISH_MSGPACK_TESTS 2
+#else
+#define PUBLISH_MSGPACK_TESTS 0
+#endif
+#define TESTS (BYTES_TO_LEN_TESTS + LEN_TO_BYTES_TESTS + PUBLISH_TESTS + PUBLISH_MSGPACK_TESTS)
 
 void test_bytes_to_len() {
 	uint8_t bytes[3] = {0, 0, 3};
@@ -45,11 +55,92 @@ void test_len_to_bytes() {
 	ok(bytes[0] == 3 && bytes[1] == 0 && bytes[2] == 0, "len to bytes, large value");
 }
 
+#ifndef VIADUCT_NO_PUBLISHER
+size_t serialized_len;
+
+void serialize_record(struct wamp_client* cl, wamp_type_list msg) {
+	serialized_len = msg.len;
+}
+
+void test_publish_custom_serializer() {
+	struct wamp_client cl;
+	memset(&cl, 0, sizeof(cl));
+	cl.serialize = serialize_record;
+
+	wamp_type_string topic = {.len = 8, .val = "messages"};
+
+	serialized_len = 0;
+	viaduct_publish(&cl, NULL, topic, NULL, NULL);
+	cmp_ok(serialized_len, "==", 4, "publish, custom serializer, no args");
+
+	struct wamp_type arg_list[] = {
+		{ .type = TYPE_INT, .integer = 1 },
+	};
+	wamp_type_list args = {.len = 1, .val = arg_list};
+
+	serialized_len = 0;
+	viaduct_publish(&cl, NULL, topic, &args, NULL);
+	cmp_ok(serialized_len, "==", 5, "publish, custom serializer, args");
+}
+#endif
+
+#if !defined(VIADUCT_NO_PUBLISHER) && !defined(VIADUCT_NO_MSGPACK)
+uint8_t written[64];
+size_t written_len;
+
+size_t write_record(struct wamp_client* cl, const uint8_t* buf, size_t len) {
+	memcpy(written + written_len, buf, len);
+	written_len += len;
+	return len;
+}
+
+void test_publish_msgpack() {
+	struct wamp_client cl;
+	memset(&cl, 0, sizeof(cl));
+	cl.write = write_record;
+	cl.serialize = serialize_msgpack;
+
+	wamp_type_string topic = {.len = 8, .val = "messages"};
+
+	// [PUBLISH, 1, {}, "messages"]
+	const uint8_t no_args[] = {
+		0, 0, 0, 13,
+		0x94, WAMP_PUBLISH, 1, 0x80,
+		0xa8, 'm', 'e', 's', 's', 'a', 'g', 'e', 's',
+	};
+	written_len = 0;
+	viaduct_publish(&cl, NULL, topic, NULL, NULL);
+	ok(written_len == sizeof(no_args) && memcmp(written, no_args, sizeof(no_args)) == 0, "publish, msgpack, no args");
+
+	struct wamp_type arg_list[] = {
+		{ .type = TYPE_INT, .integer = 1 },
+	};
+	wamp_type_list args = {.len = 1, .val = arg_list};
+
+	// [PUBLISH, 2, {}, "messages", [1]]
+	const uint8_t with_args[] = {
+		0, 0, 0, 15,
+		0x95, WAMP_PUBLISH, 2, 0x80,
+		0xa8, 'm', 'e', 's', 's', 'a', 'g', 'e', 's',
+		0x91, 1,
+	};
+	written_len = 0;
+	viaduct_publish(&cl, NULL, topic, &args, NULL);
+	ok(written_len == sizeof(with_args) && memcmp(written, with_args, sizeof(with_args)) == 0, "publish, msgpack, args");
+}
+#endif
+
 int main(int argc, char* argv[]) {
 	plan(TESTS);
 
 	test_bytes_to_len();
 	test_len_to_bytes();
+#ifndef VIADUCT_NO_PUBLISHER
+	test_publish_custom_serializer();
+#endif
+#if !defined(VIADUCT_NO_PUBLISHER) && !defined(VIADUCT_NO_MSGPACK)
+	test_publish_msgpack();
+#endif
 
 	done_testing();
 }
@@ -7,21 +7,38 @@
 #include <stdio.h>
 #endif
 
+#ifndef VIADUCT_NO_MSGPACK
 #include "vendor/cmp.h"
+#endif
 
 #include "viaduct.h"
 
-void debug(char* fmt, ...) {
 #ifdef DEBUG
+void debug(char* fmt, ...) {
 	va_list args;
 	va_start(args, fmt);
 	vprintf(fmt, args);
 	va_end(args);
-#endif
 }
+#else
+// drop the call and its format string entirely
+#define debug(...)
+#endif
 
 void viaduct_send_message(struct wamp_client* cl, uint8_t* buf, size_t len);
 
+// viaduct_serialize calls the serializer chosen during the handshake
+// the built-in serializer is called directly so it can be inlined
+static inline void viaduct_serialize(struct wamp_client* cl, wamp_type_list msg) {
+#ifndef VIADUCT_NO_MSGPACK
+	if (cl->serialize == serialize_msgpack) {
+		serialize_msgpack(cl, msg);
+		return;
+	}
+#endif
+	cl->serialize(cl, msg);
+}
+
 struct wamp_type viaduct_empty_dict() {
 	struct wamp_type t = { TYPE_DICT };
 	t.dict.len = 0;
@@ -99,7 +116,7 @@ void viaduct_join_realm(struct wamp_client* cl, const char* realm, size_t realm_
 	msg[1].string.len = realm_len;
 	msg[1].string.val = realm;
 	wamp_type_list msglist = { 3, msg };
-	cl->serialize(cl, msglist);
+	viaduct_serialize(cl, msglist);
 	viaduct_send_message(cl, cl->buf, cl->buf_len);
 }
 
@@ -155,11 +172,14 @@ void viaduct_send_message(struct wamp_client* cl, uint8_t* buf, size_t len) {
 	cl->write(cl, buf, len);
 }
 
+#ifndef VIADUCT_NO_PUBLISHER
 uint64_t viaduct_next_request_id(struct wamp_client* cl) {
 	cl->next_id++;
 	return cl->next_id;
 }
+#endif
 
+#ifndef VIADUCT_NO_MSGPACK
 void msgpack_write_type(cmp_ctx_t* ctx, struct wamp_type type);
 
 void msgpack_write_list(cmp_ctx_t* ctx, wamp_type_list list) {
@@ -227,7 +247,9 @@ void serialize_msgpack(struct wamp_client* cl, const wamp_type_list msg) {
 	msgpack_write_list(&cmp, msg);
 	viaduct_send_message(cl, cl->buf, cl->buf_len);
 }
+#endif
 
+#ifndef VIADUCT_NO_PUBLISHER
 void viaduct_publish(struct wamp_client* cl, const wamp_type_dict* options, const wamp_type_string topic, const wamp_type_list* args, const wamp_type_dict* kw_args) {
 	int msg_len = 4;
 
@@ -261,6 +283,7 @@ void viaduct_publish(struct wamp_client* cl, const wamp_type_dict* options, cons
 	}
 
 	wamp_type_list msglist = { msg_len, msg };
-	cl->serialize(cl, msglist);
+	viaduct_serialize(cl, msglist);
 }
+#endif
 
@@ -130,9 +130,14 @@ extern "C" {
 int viaduct_handshake(struct wamp_client* cl, struct raw_socket_options);
 bool viaduct_handle_message(struct wamp_client* cl);
 void viaduct_join_realm(struct wamp_client* cl, const char* realm, size_t realm_len, wamp_type_dict details);
+
+#ifndef VIADUCT_NO_PUBLISHER
 void viaduct_publish(struct wamp_client* cl, const wamp_type_dict* options, const wamp_type_string topic, const wamp_type_list* args, const wamp_type_dict* kw_args);
+#endif
 
+#ifndef VIADUCT_NO_MSGPACK
 void serialize_msgpack(struct wamp_client* cl, wamp_type_list msg);
+#endif
 
 struct wamp_type viaduct_empty_dict();
 